@@ -16,3 +16,30 @@ AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_DodecahedronCreate(MeshMod_Regis
 
 AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_DiamondCreate(MeshMod_RegistryHandle registry);
 AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_AABB3FCreate(MeshMod_RegistryHandle registry, Math_Aabb3F aabb);
+
+// the shape cache interns generated shapes by a fingerprint of the generator
+// parameters, so repeated requests for the same shape return the same mesh.
+// cached meshes are shared by every caller so are handed out as a read-only
+// MeshModShapes_SharedMeshHandle. Use MeshModShapes_SharedMeshClone to get a
+// mesh you own and can edit, MeshModShapes_SharedMeshPeek only for reading.
+// meshes stay owned by the registry, destroying the cache just forgets them.
+// a cached mesh destroyed through the registry is regenerated on next request.
+typedef struct MeshModShapes_Cache* MeshModShapes_CacheHandle;
+typedef struct MeshModShapes_SharedMeshHandle { MeshMod_MeshHandle mesh; } MeshModShapes_SharedMeshHandle;
+
+AL2O3_EXTERN_C MeshModShapes_CacheHandle MeshModShapes_CacheCreate(MeshMod_RegistryHandle registry);
+AL2O3_EXTERN_C void MeshModShapes_CacheDestroy(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C uint32_t MeshModShapes_CacheMeshCount(MeshModShapes_CacheHandle cache);
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheTetrahedon(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheCube(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheOctahedron(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheIcosahedron(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheDodecahedron(MeshModShapes_CacheHandle cache);
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheDiamond(MeshModShapes_CacheHandle cache);
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheAABB3F(MeshModShapes_CacheHandle cache, Math_Aabb3F aabb);
+
+AL2O3_EXTERN_C bool MeshModShapes_SharedMeshIsValid(MeshModShapes_SharedMeshHandle shared);
+AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_SharedMeshPeek(MeshModShapes_SharedMeshHandle shared);
+AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_SharedMeshClone(MeshModShapes_SharedMeshHandle shared);
@@ -0,0 +1,256 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_cmath/aabb.h"
+#include "al2o3_memory/memory.h"
+#include "render_meshmod/meshmod.h"
+#include "render_meshmod/mesh.h"
+#include "render_meshmodshapes/shapes.h"
+
+// generator id + parameters, the generated mesh data is a pure function of these
+// so they fingerprint the mesh without having to walk it
+typedef enum MeshModShapes_CacheKind {
+	MeshModShapes_CacheKindTetrahedon = 1,
+	MeshModShapes_CacheKindCube,
+	MeshModShapes_CacheKindOctahedron,
+	MeshModShapes_CacheKindIcosahedron,
+	MeshModShapes_CacheKindDodecahedron,
+	MeshModShapes_CacheKindDiamond,
+	MeshModShapes_CacheKindAABB3F,
+} MeshModShapes_CacheKind;
+
+typedef struct MeshModShapes_CacheKey {
+	uint32_t kind;
+	float params[6];
+} MeshModShapes_CacheKey;
+
+typedef struct MeshModShapes_CacheEntry {
+	uint64_t fingerprint;
+	MeshModShapes_CacheKey key;
+	MeshMod_MeshHandle mesh;
+	bool used;
+} MeshModShapes_CacheEntry;
+
+typedef struct MeshModShapes_Cache {
+	MeshMod_RegistryHandle registry;
+	uint32_t capacity; // always a power of 2
+	uint32_t count;
+	MeshModShapes_CacheEntry* entries;
+} MeshModShapes_Cache;
+
+static const uint32_t InitialCapacity = 16;
+
+static uint64_t Fingerprint(MeshModShapes_CacheKey const* key) {
+	// FNV-1a 64 bit
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	uint8_t const* bytes = (uint8_t const*) key;
+	for (size_t i = 0u; i < sizeof(MeshModShapes_CacheKey); ++i) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+static bool KeyEqual(MeshModShapes_CacheKey const* a, MeshModShapes_CacheKey const* b) {
+	return memcmp(a, b, sizeof(MeshModShapes_CacheKey)) == 0;
+}
+
+static MeshModShapes_CacheEntry* FindSlot(MeshModShapes_CacheEntry* entries,
+																					uint32_t capacity,
+																					uint64_t fingerprint,
+																					MeshModShapes_CacheKey const* key) {
+	uint32_t const mask = capacity - 1;
+	uint32_t index = (uint32_t) fingerprint & mask;
+	while (entries[index].used) {
+		if (entries[index].fingerprint == fingerprint && KeyEqual(&entries[index].key, key)) {
+			break;
+		}
+		index = (index + 1) & mask;
+	}
+	return entries + index;
+}
+
+static bool Grow(MeshModShapes_Cache* cache) {
+	uint32_t const newCapacity = cache->capacity * 2;
+	MeshModShapes_CacheEntry* newEntries =
+			(MeshModShapes_CacheEntry*) MEMORY_CALLOC(newCapacity, sizeof(MeshModShapes_CacheEntry));
+	if (!newEntries) {
+		return false;
+	}
+
+	for (uint32_t i = 0u; i < cache->capacity; ++i) {
+		MeshModShapes_CacheEntry const* entry = cache->entries + i;
+		if (!entry->used) {
+			continue;
+		}
+		*FindSlot(newEntries, newCapacity, entry->fingerprint, &entry->key) = *entry;
+	}
+
+	MEMORY_FREE(cache->entries);
+	cache->entries = newEntries;
+	cache->capacity = newCapacity;
+	return true;
+}
+
+static MeshMod_MeshHandle Generate(MeshMod_RegistryHandle registry, MeshModShapes_CacheKey const* key) {
+	switch ((MeshModShapes_CacheKind) key->kind) {
+		case MeshModShapes_CacheKindTetrahedon: return MeshModShapes_TetrahedonCreate(registry);
+		case MeshModShapes_CacheKindCube: return MeshModShapes_CubeCreate(registry);
+		case MeshModShapes_CacheKindOctahedron: return MeshModShapes_OctahedronCreate(registry);
+		case MeshModShapes_CacheKindIcosahedron: return MeshModShapes_IcosahedronCreate(registry);
+		case MeshModShapes_CacheKindDodecahedron: return MeshModShapes_DodecahedronCreate(registry);
+		case MeshModShapes_CacheKindDiamond: return MeshModShapes_DiamondCreate(registry);
+		case MeshModShapes_CacheKindAABB3F: {
+			Math_Aabb3F aabb;
+			aabb.minExtent = Math_FromVec3F(key->params + 0);
+			aabb.maxExtent = Math_FromVec3F(key->params + 3);
+			return MeshModShapes_AABB3FCreate(registry, aabb);
+		}
+	}
+	ASSERT(false);
+	MeshMod_MeshHandle const invalid = {0};
+	return invalid;
+}
+
+static MeshMod_MeshHandle Intern(MeshModShapes_CacheHandle cache, MeshModShapes_CacheKey const* key) {
+	ASSERT(cache);
+
+	uint64_t const fingerprint = Fingerprint(key);
+	MeshModShapes_CacheEntry* entry = FindSlot(cache->entries, cache->capacity, fingerprint, key);
+	if (entry->used) {
+		if (MeshMod_MeshHandleIsValid(entry->mesh)) {
+			return entry->mesh;
+		}
+		// the cached mesh was destroyed behind our back, regenerate it in place
+		MeshMod_MeshHandle const mesh = Generate(cache->registry, key);
+		if (MeshMod_MeshHandleIsValid(mesh)) {
+			entry->mesh = mesh;
+		}
+		return mesh;
+	}
+
+	MeshMod_MeshHandle const mesh = Generate(cache->registry, key);
+	// never intern a failed generate, the next request should get to retry
+	if (!MeshMod_MeshHandleIsValid(mesh)) {
+		return mesh;
+	}
+
+	// keep load factor <= 1/2 so probes stay short, if we can't grow just don't intern
+	if ((cache->count + 1) * 2 > cache->capacity) {
+		if (!Grow(cache)) {
+			return mesh;
+		}
+		entry = FindSlot(cache->entries, cache->capacity, fingerprint, key);
+	}
+
+	entry->fingerprint = fingerprint;
+	entry->key = *key;
+	entry->mesh = mesh;
+	entry->used = true;
+	cache->count++;
+
+	return mesh;
+}
+
+static MeshModShapes_SharedMeshHandle Share(MeshMod_MeshHandle mesh) {
+	MeshModShapes_SharedMeshHandle shared;
+	shared.mesh = mesh;
+	return shared;
+}
+
+static MeshModShapes_SharedMeshHandle InternKind(MeshModShapes_CacheHandle cache, MeshModShapes_CacheKind kind) {
+	MeshModShapes_CacheKey key;
+	memset(&key, 0, sizeof(MeshModShapes_CacheKey));
+	key.kind = kind;
+	return Share(Intern(cache, &key));
+}
+
+AL2O3_EXTERN_C MeshModShapes_CacheHandle MeshModShapes_CacheCreate(MeshMod_RegistryHandle registry) {
+	MeshModShapes_Cache* cache = (MeshModShapes_Cache*) MEMORY_CALLOC(1, sizeof(MeshModShapes_Cache));
+	if (!cache) {
+		return nullptr;
+	}
+	cache->entries = (MeshModShapes_CacheEntry*) MEMORY_CALLOC(InitialCapacity, sizeof(MeshModShapes_CacheEntry));
+	if (!cache->entries) {
+		MEMORY_FREE(cache);
+		return nullptr;
+	}
+	cache->registry = registry;
+	cache->capacity = InitialCapacity;
+	return cache;
+}
+
+AL2O3_EXTERN_C void MeshModShapes_CacheDestroy(MeshModShapes_CacheHandle cache) {
+	if (!cache) {
+		return;
+	}
+	MEMORY_FREE(cache->entries);
+	MEMORY_FREE(cache);
+}
+
+AL2O3_EXTERN_C uint32_t MeshModShapes_CacheMeshCount(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return cache->count;
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheTetrahedon(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindTetrahedon);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheCube(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindCube);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheOctahedron(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindOctahedron);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheIcosahedron(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindIcosahedron);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheDodecahedron(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindDodecahedron);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheDiamond(MeshModShapes_CacheHandle cache) {
+	ASSERT(cache);
+	return InternKind(cache, MeshModShapes_CacheKindDiamond);
+}
+
+AL2O3_EXTERN_C MeshModShapes_SharedMeshHandle MeshModShapes_CacheAABB3F(MeshModShapes_CacheHandle cache, Math_Aabb3F aabb) {
+	ASSERT(cache);
+	MeshModShapes_CacheKey key;
+	memset(&key, 0, sizeof(MeshModShapes_CacheKey));
+	key.kind = MeshModShapes_CacheKindAABB3F;
+	float const extents[6] = {
+			aabb.minExtent.x, aabb.minExtent.y, aabb.minExtent.z,
+			aabb.maxExtent.x, aabb.maxExtent.y, aabb.maxExtent.z,
+	};
+	for (uint32_t i = 0u; i < 6; ++i) {
+		// NaN extents never compare equal, don't intern them
+		if (extents[i] != extents[i]) {
+			return Share(MeshModShapes_AABB3FCreate(cache->registry, aabb));
+		}
+		// + 0 folds -0 into 0 so equal boxes have equal bits
+		key.params[i] = extents[i] + 0.0f;
+	}
+	return Share(Intern(cache, &key));
+}
+
+AL2O3_EXTERN_C bool MeshModShapes_SharedMeshIsValid(MeshModShapes_SharedMeshHandle shared) {
+	return MeshMod_MeshHandleIsValid(shared.mesh);
+}
+
+AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_SharedMeshPeek(MeshModShapes_SharedMeshHandle shared) {
+	ASSERT(MeshMod_MeshHandleIsValid(shared.mesh));
+	return shared.mesh;
+}
+
+AL2O3_EXTERN_C MeshMod_MeshHandle MeshModShapes_SharedMeshClone(MeshModShapes_SharedMeshHandle shared) {
+	ASSERT(MeshMod_MeshHandleIsValid(shared.mesh));
+	return MeshMod_MeshClone(shared.mesh);
+}
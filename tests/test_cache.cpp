@@ -0,0 +1,130 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "render_meshmod/meshmod.h"
+#include "render_meshmod/registry.h"
+#include "render_meshmod/mesh.h"
+#include "render_meshmodshapes/shapes.h"
+#include <limits>
+
+static bool SameMesh(MeshModShapes_SharedMeshHandle a, MeshModShapes_SharedMeshHandle b) {
+	return memcmp(&a.mesh, &b.mesh, sizeof(MeshMod_MeshHandle)) == 0;
+}
+
+static Math_Aabb3F MakeAabb(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+	Math_Aabb3F aabb;
+	aabb.minExtent.x = minX; aabb.minExtent.y = minY; aabb.minExtent.z = minZ;
+	aabb.maxExtent.x = maxX; aabb.maxExtent.y = maxY; aabb.maxExtent.z = maxZ;
+	return aabb;
+}
+
+TEST_CASE("Cache create/destroy", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+	REQUIRE(cache);
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 0);
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache repeated shapes share a mesh", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	MeshModShapes_SharedMeshHandle cube0 = MeshModShapes_CacheCube(cache);
+	REQUIRE(MeshModShapes_SharedMeshIsValid(cube0));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 1);
+	MeshModShapes_SharedMeshHandle cube1 = MeshModShapes_CacheCube(cache);
+	REQUIRE(SameMesh(cube0, cube1));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 1);
+
+	Math_Aabb3F const box = MakeAabb(-1, -2, -3, 1, 2, 3);
+	MeshModShapes_SharedMeshHandle box0 = MeshModShapes_CacheAABB3F(cache, box);
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 2);
+	MeshModShapes_SharedMeshHandle box1 = MeshModShapes_CacheAABB3F(cache, box);
+	REQUIRE(SameMesh(box0, box1));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 2);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache different extents give different meshes", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	MeshModShapes_SharedMeshHandle box0 = MeshModShapes_CacheAABB3F(cache, MakeAabb(0, 0, 0, 1, 1, 1));
+	MeshModShapes_SharedMeshHandle box1 = MeshModShapes_CacheAABB3F(cache, MakeAabb(0, 0, 0, 1, 1, 2));
+	REQUIRE(!SameMesh(box0, box1));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 2);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache -0 and 0 extents share a mesh", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	MeshModShapes_SharedMeshHandle box0 = MeshModShapes_CacheAABB3F(cache, MakeAabb(-0.0f, -0.0f, -0.0f, 1, 1, 1));
+	MeshModShapes_SharedMeshHandle box1 = MeshModShapes_CacheAABB3F(cache, MakeAabb(0.0f, 0.0f, 0.0f, 1, 1, 1));
+	REQUIRE(SameMesh(box0, box1));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 1);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache NaN extents are not interned", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	float const nan = std::numeric_limits<float>::quiet_NaN();
+	Math_Aabb3F const box = MakeAabb(nan, 0, 0, 1, 1, 1);
+	MeshModShapes_SharedMeshHandle box0 = MeshModShapes_CacheAABB3F(cache, box);
+	MeshModShapes_SharedMeshHandle box1 = MeshModShapes_CacheAABB3F(cache, box);
+	REQUIRE(MeshModShapes_SharedMeshIsValid(box0));
+	REQUIRE(!SameMesh(box0, box1));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 0);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache keeps entries when growing", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	// well past the initial capacity's load limit so it grows more than once
+	static const uint32_t NumBoxes = 40;
+	MeshModShapes_SharedMeshHandle boxes[NumBoxes];
+	for (uint32_t i = 0u; i < NumBoxes; ++i) {
+		boxes[i] = MeshModShapes_CacheAABB3F(cache, MakeAabb(0, 0, 0, 1, 1, (float) (i + 1)));
+	}
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == NumBoxes);
+
+	for (uint32_t i = 0u; i < NumBoxes; ++i) {
+		MeshModShapes_SharedMeshHandle box = MeshModShapes_CacheAABB3F(cache, MakeAabb(0, 0, 0, 1, 1, (float) (i + 1)));
+		REQUIRE(SameMesh(box, boxes[i]));
+	}
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == NumBoxes);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}
+
+TEST_CASE("Cache regenerates a destroyed mesh", "[MeshModShapes Cache]") {
+	MeshMod_RegistryHandle registry = MeshMod_RegistryCreateWithDefaults();
+	MeshModShapes_CacheHandle cache = MeshModShapes_CacheCreate(registry);
+
+	MeshModShapes_SharedMeshHandle cube0 = MeshModShapes_CacheCube(cache);
+	MeshMod_MeshDestroy(MeshModShapes_SharedMeshPeek(cube0));
+	REQUIRE(!MeshModShapes_SharedMeshIsValid(cube0));
+
+	MeshModShapes_SharedMeshHandle cube1 = MeshModShapes_CacheCube(cache);
+	REQUIRE(MeshModShapes_SharedMeshIsValid(cube1));
+	REQUIRE(SameMesh(cube1, MeshModShapes_CacheCube(cache)));
+	REQUIRE(MeshModShapes_CacheMeshCount(cache) == 1);
+
+	MeshModShapes_CacheDestroy(cache);
+	MeshMod_RegistryDestroy(registry);
+}